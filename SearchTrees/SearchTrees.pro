@@ -39,6 +39,8 @@ HEADERS += \
     bstnode.hh \
     simplebstbalancer.hh \
     bsttrees.hh \
-    redblackbalancer.hh
+    redblackbalancer.hh \
+    nodeallocator.hh \
+    bulkload.hh
 
 DISTFILES +=
@@ -10,68 +10,161 @@
 #include "aatree.hh"
 #include <algorithm>
 
-template<typename Node>
-AATree<Node>::AATree() :
-    BinarySearchTree<Node>{}
+template<typename Node, template<typename> class Allocator>
+AATree<Node, Allocator>::AATree() :
+    BinarySearchTree<Node, Allocator>{}
 {
 }
 
-template<typename Node>
-AATree<Node>::~AATree()
+template<typename Node, template<typename> class Allocator>
+template<typename ForwardIt>
+AATree<Node, Allocator>::AATree(ForwardIt first, ForwardIt last) :
+    BinarySearchTree<Node, Allocator>{}
 {
+    this->bulkLoad(first, last);
 }
 
-template<typename Node>
-bool AATree<Node>::insert(const value_type& value)
+template<typename Node, template<typename> class Allocator>
+AATree<Node, Allocator>::~AATree()
 {
-    if (this->find(value.first) != this->nil_)
-    {
-        return false;
-    }
+}
+
+template<typename Node, template<typename> class Allocator>
+void AATree<Node, Allocator>::setBulkLoadBalance(Node* node, const BulkLoadShape& shape)
+{
+    // Single children are always right children and the right subtree is
+    // never shorter, so the rank gives a valid level for every node
+    node->level_ = shape.rank_;
+}
 
+template<typename Node, template<typename> class Allocator>
+Node* AATree<Node, Allocator>::insertAt(Node* parent, const key_type& key, const mapped_type& value)
+{
     Node* node{
-        new Node{ value.first, value.second,
-                  this->nil_, this->nil_, this->nil_, 1 } };
+        this->allocator_.create(key, value,
+                                parent, this->nil_, this->nil_, 1) };
 
-    if (this->root_ == this->nil_)
+    if (parent == this->nil_)
     {
         this->root_ = node;
-        ++this->nodes_;
+    }
+    else if (node->key_ < parent->key_)
+    {
+        parent->left_ = node;
     }
     else
     {
-        this->root_ = insertNode(node, this->root_);
+        parent->right_ = node;
+    }
+    ++this->nodes_;
+
+    // Skew and split the ancestors bottom up. The split of a node looks two
+    // levels down, so the rest of the ancestors are already correct once two
+    // consecutive subtrees keep both their root and its level.
+    bool childChanged{ true };
+    Node* x{ parent };
+    while (x != this->nil_)
+    {
+        Node* xParent{ x->parent_ };
+        int level{ x->level_ };
+
+        Node* y{ split(skew(x)) };
+        bool changed{ y != x or y->level_ != level };
+        if (not changed and not childChanged)
+        {
+            break;
+        }
+
+        replaceChild(xParent, x, y);
+        childChanged = changed;
+        x = xParent;
     }
 
-    return true;
+    return node;
 }
 
-template<typename Node>
-typename AATree<Node>::size_type AATree<Node>::erase(const key_type& key)
+template<typename Node, template<typename> class Allocator>
+void AATree<Node, Allocator>::eraseNode(Node* node)
 {
-    auto node{ this->find(key) };
-    if (node == this->nil_)
+    // A node with children is replaced with its predecessor or successor,
+    // which is always a leaf in an AA tree
+    Node* leaf{ node };
+    if (node->left_ != this->nil_)
+    {
+        leaf = this->maximum(node->left_);
+    }
+    else if (node->right_ != this->nil_)
     {
-        return 0;
+        leaf = node->right_;
     }
 
-    --this->nodes_;
+    Node* x{ leaf->parent_ };
+    replaceChild(leaf->parent_, leaf, this->nil_);
+
+    if (leaf != node)
+    {
+        if (x == node)
+        {
+            x = leaf;
+        }
 
-    int key1{ node->key_ };
+        leaf->left_ = node->left_;
+        leaf->right_ = node->right_;
+        leaf->level_ = node->level_;
+        leaf->parent_ = node->parent_;
+        if (leaf->left_ != this->nil_)
+        {
+            leaf->left_->parent_ = leaf;
+        }
+        if (leaf->right_ != this->nil_)
+        {
+            leaf->right_->parent_ = leaf;
+        }
+        replaceChild(node->parent_, node, leaf);
+    }
 
-    this->root_ = deleteNode(node, this->root_);
+    this->allocator_.destroy(node);
+    --this->nodes_;
 
-    int key2{ (node != this->nil_) ? node->key_ : key1 - 1 };
-    if (key1 == key2)
+    // Rebalance the ancestors of the removed leaf bottom up
+    while (x != this->nil_)
     {
-        delete node;
+        Node* xParent{ x->parent_ };
+
+        Node* y{ decreaseLevel(x) };
+        y = skew(y);
+        y->right_ = skew(y->right_);
+        if (y->right_ != this->nil_)
+        {
+            y->right_->right_ = skew(y->right_->right_);
+        }
+        y = split(y);
+        y->right_ = split(y->right_);
+
+        replaceChild(xParent, x, y);
+        x = xParent;
     }
+}
 
-    return 1;
+template<typename Node, template<typename> class Allocator>
+void AATree<Node, Allocator>::replaceChild(Node* parent, Node* oldChild, Node* newChild)
+{
+    if (parent == this->nil_)
+    {
+        this->root_ = newChild;
+    }
+    else if (parent->left_ == oldChild)
+    {
+        parent->left_ = newChild;
+    }
+    else
+    {
+        parent->right_ = newChild;
+    }
 }
 
-template<typename Node>
-Node* AATree<Node>::skew(Node* node)
+template<typename Node, template<typename> class Allocator>
+Node* AATree<Node, Allocator>::skew(Node* node)
 {
     if (node == this->nil_)
     {
@@ -100,8 +193,8 @@ Node* AATree<Node>::skew(Node* node)
     }
 }
 
-template<typename Node>
-Node* AATree<Node>::split(Node* node)
+template<typename Node, template<typename> class Allocator>
+Node* AATree<Node, Allocator>::split(Node* node)
 {
     if (node == this->nil_)
     {
@@ -131,114 +224,8 @@ Node* AATree<Node>::split(Node* node)
     }
 }
 
-template<typename Node>
-Node* AATree<Node>::insertNode(Node* node, Node* rootNode)
-{
-    if (node->key_ < rootNode->key_)
-    {
-        if (rootNode->left_ == this->nil_)
-        {
-            node->parent_ = rootNode;
-            rootNode->left_ = node;
-            ++this->nodes_;
-
-            rootNode = skew(rootNode);
-            rootNode = split(rootNode);
-            return rootNode;
-        }
-        else
-        {
-            rootNode->left_ = insertNode(node, rootNode->left_);
-        }
-    }
-    else
-    {
-        if (rootNode->right_ == this->nil_)
-        {
-            node->parent_ = rootNode;
-            rootNode->right_ = node;
-            ++this->nodes_;
-
-            rootNode = skew(rootNode);
-            rootNode = split(rootNode);
-            return rootNode;
-        }
-        else
-        {
-            rootNode->right_ = insertNode(node, rootNode->right_);
-        }
-    }
-
-    rootNode = skew(rootNode);
-    rootNode = split(rootNode);
-    return rootNode;
-}
-
-template<typename Node>
-Node* AATree<Node>::deleteNode(Node* node, Node* rootNode)
-{
-    if (rootNode == this->nil_ or node == this->nil_)
-    {
-        return rootNode;
-    }
-
-    if (node == rootNode)
-    {
-        if (rootNode->left_ == this->nil_ and rootNode->right_ == this->nil_)
-        {
-            return this->nil_;
-        }
-        else if (rootNode->left_ == this->nil_)
-        {
-            Node* L{ this->successor(rootNode) };
-            rootNode->right_ = deleteNode(L, rootNode->right_);
-            if (rootNode->right_ != this->nil_)
-            {
-                rootNode->right_->parent_ = rootNode;
-            }
-            rootNode->key_ = L->key_;
-            delete L;
-            L = this->nil_;
-        }
-        else
-        {
-            Node* L{ this->predecessor(rootNode) };
-            rootNode->left_ = deleteNode(L, rootNode->left_);
-            if (rootNode->left_ != this->nil_)
-            {
-                rootNode->left_->parent_ = rootNode;
-            }
-            rootNode->key_ = L->key_;
-            delete L;
-            L = this->nil_;
-       }
-    }
-    else if (node->key_ > rootNode->key_)
-    {
-        rootNode->right_ = deleteNode(node, rootNode->right_);
-    }
-    else
-    {
-        rootNode->left_ = deleteNode(node, rootNode->left_);
-    }
-
-    rootNode = decreaseLevel(rootNode);
-    rootNode = skew(rootNode);
-    rootNode->right_ = skew(rootNode->right_);
-
-    if (rootNode->right_ != this->nil_)
-    {
-        rootNode->right_->right_ = skew(rootNode->right_->right_);
-    }
-
-    rootNode = split(rootNode);
-    rootNode->right_ = split(rootNode->right_);
-
-    return rootNode;
-}
-
-template<typename Node>
-Node* AATree<Node>::decreaseLevel(Node* node)
+template<typename Node, template<typename> class Allocator>
+Node* AATree<Node, Allocator>::decreaseLevel(Node* node)
 {
     if (node == this->nil_)
     {
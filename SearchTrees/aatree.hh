@@ -64,28 +64,32 @@ struct AANode
     }
 };
 
-template<typename Node>
-class AATree : public BinarySearchTree<Node>
+template<typename Node, template<typename> class Allocator = NodeAllocator>
+class AATree : public BinarySearchTree<Node, Allocator>
 {
 public:
     using key_type = typename Node::key_type;
     using mapped_type = typename Node::mapped_type;
     using value_type = std::pair<const key_type, mapped_type>;
-    using size_type = typename BinarySearchTree<Node>::size_type;
+    using size_type = typename BinarySearchTree<Node, Allocator>::size_type;
     using node_type = Node;
 
     AATree();
+    template<typename ForwardIt>
+    AATree(ForwardIt first, ForwardIt last);
     virtual ~AATree();
 
-    virtual bool insert(const value_type& value);
-    virtual size_type erase(const key_type& key);
+protected:
+    virtual void setBulkLoadBalance(Node* node, const BulkLoadShape& shape);
+    virtual Node* insertAt(Node* parent, const key_type& key, const mapped_type& value);
+    virtual void eraseNode(Node* node);
 
 private:
     Node* skew(Node* node);
     Node* split(Node* node);
-    Node* insertNode(Node* node, Node* rootNode);
-    Node* deleteNode(Node* node, Node* rootNode);
     Node* decreaseLevel(Node* node);
+    // Replaces oldChild of parent, or the root if parent is nil, with newChild
+    void replaceChild(Node* parent, Node* oldChild, Node* newChild);
 };
 
 #include "aatree.cpp"
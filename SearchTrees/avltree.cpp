@@ -9,43 +9,37 @@
 
 #include "avltree.hh"
 
-template<typename Node>
-AVLTree<Node>::AVLTree() :
-    BinarySearchTree<Node>{}
+template<typename Node, template<typename> class Allocator>
+AVLTree<Node, Allocator>::AVLTree() :
+    BinarySearchTree<Node, Allocator>{}
 {
 }
 
-template<typename Node>
-AVLTree<Node>::~AVLTree()
+template<typename Node, template<typename> class Allocator>
+template<typename ForwardIt>
+AVLTree<Node, Allocator>::AVLTree(ForwardIt first, ForwardIt last) :
+    BinarySearchTree<Node, Allocator>{}
 {
+    this->bulkLoad(first, last);
 }
 
-template<typename Node>
-bool AVLTree<Node>::insert(const value_type& value)
+template<typename Node, template<typename> class Allocator>
+AVLTree<Node, Allocator>::~AVLTree()
 {
-    Node* x{ this->root_ };
-    Node* parent{ this->nil_ };
+}
 
-    while (x != this->nil_)
-    {
-        parent = x;
-        if (value.first < x->key_)
-        {
-            x = x->left_;
-        }
-        else if (x->key_ < value.first)
-        {
-            x = x->right_;
-        }
-        else
-        {
-            return false;
-        }
-    }
+template<typename Node, template<typename> class Allocator>
+void AVLTree<Node, Allocator>::setBulkLoadBalance(Node* node, const BulkLoadShape& shape)
+{
+    node->balance_ = shape.leftHeight_ - shape.rightHeight_;
+}
 
+template<typename Node, template<typename> class Allocator>
+Node* AVLTree<Node, Allocator>::insertAt(Node* parent, const key_type& key, const mapped_type& value)
+{
     Node* node{
-        new Node{ value.first, value.second,
-                  parent, this->nil_, this->nil_, 0 } };
+        this->allocator_.create(key, value,
+                                parent, this->nil_, this->nil_, 0) };
 
     ++this->nodes_;
 
@@ -64,18 +58,12 @@ bool AVLTree<Node>::insert(const value_type& value)
         insertBalance(parent, -1);
     }
 
-    return true;
+    return node;
 }
 
-template<typename Node>
-typename AVLTree<Node>::size_type AVLTree<Node>::erase(const key_type& key)
+template<typename Node, template<typename> class Allocator>
+void AVLTree<Node, Allocator>::eraseNode(Node* node)
 {
-    auto node{ this->find(key) };
-    if (node == this->nil_)
-    {
-        return 0;
-    }
-
     Node* left{ node->left_ };
     Node* right{ node->right_ };
 
@@ -85,7 +73,7 @@ typename AVLTree<Node>::size_type AVLTree<Node>::erase(const key_type& key)
         {
             if (node == this->root_)
             {
-                delete this->root_;
+                this->allocator_.destroy(this->root_);
                 this->root_ = this->nil_;
             }
             else
@@ -94,13 +82,13 @@ typename AVLTree<Node>::size_type AVLTree<Node>::erase(const key_type& key)
                 {
                     node->parent_->left_ = this->nil_;
                     deleteBalance(node->parent_, -1);
-                    delete node;
+                    this->allocator_.destroy(node);
                 }
                 else
                 {
                     node->parent_->right_ = this->nil_;
                     deleteBalance(node->parent_, 1);
-                    delete node;
+                    this->allocator_.destroy(node);
                 }
             }
         }
@@ -146,7 +134,7 @@ typename AVLTree<Node>::size_type AVLTree<Node>::erase(const key_type& key)
             }
 
             deleteBalance(successor, 1);
-            delete node;
+            this->allocator_.destroy(node);
         }
         else
         {
@@ -200,16 +188,15 @@ typename AVLTree<Node>::size_type AVLTree<Node>::erase(const key_type& key)
             }
 
             deleteBalance(successorParent, -1);
-            delete node;
+            this->allocator_.destroy(node);
         }
     }
 
     --this->nodes_;
-    return 1;
 }
 
-template<typename Node>
-void AVLTree<Node>::insertBalance(Node* node, int balance)
+template<typename Node, template<typename> class Allocator>
+void AVLTree<Node, Allocator>::insertBalance(Node* node, int balance)
 {
     while (node != this->nil_)
     {
@@ -256,8 +243,8 @@ void AVLTree<Node>::insertBalance(Node* node, int balance)
     }
 }
 
-template<typename Node>
-Node* AVLTree<Node>::rotateLeft(Node* node)
+template<typename Node, template<typename> class Allocator>
+Node* AVLTree<Node, Allocator>::rotateLeft(Node* node)
 {
     Node* right{ node->right_ };
     Node* rightleft{ right->left_ };
@@ -292,8 +279,8 @@ Node* AVLTree<Node>::rotateLeft(Node* node)
     return right;
 }
 
-template<typename Node>
-Node* AVLTree<Node>::rotateRight(Node* node)
+template<typename Node, template<typename> class Allocator>
+Node* AVLTree<Node, Allocator>::rotateRight(Node* node)
 {
     Node* left{ node->left_ };
     Node* leftright{ left->right_ };
@@ -328,8 +315,8 @@ Node* AVLTree<Node>::rotateRight(Node* node)
     return left;
 }
 
-template<typename Node>
-Node* AVLTree<Node>::rotateLeftRight(Node* node)
+template<typename Node, template<typename> class Allocator>
+Node* AVLTree<Node, Allocator>::rotateLeftRight(Node* node)
 {
     Node* left{ node->left_ };
     Node* leftright{ left->right_ };
@@ -389,8 +376,8 @@ Node* AVLTree<Node>::rotateLeftRight(Node* node)
     return leftright;
 }
 
-template<typename Node>
-Node* AVLTree<Node>::rotateRightLeft(Node* node)
+template<typename Node, template<typename> class Allocator>
+Node* AVLTree<Node, Allocator>::rotateRightLeft(Node* node)
 {
     Node* right{ node->right_ };
     Node* rightleft{ right->left_ };
@@ -450,8 +437,8 @@ Node* AVLTree<Node>::rotateRightLeft(Node* node)
     return rightleft;
 }
 
-template<typename Node>
-void AVLTree<Node>::deleteBalance(Node* node, int balance)
+template<typename Node, template<typename> class Allocator>
+void AVLTree<Node, Allocator>::deleteBalance(Node* node, int balance)
 {
     while (node != this->nil_)
     {
@@ -504,8 +491,8 @@ void AVLTree<Node>::deleteBalance(Node* node, int balance)
     }
 }
 
-template<typename Node>
-void AVLTree<Node>::replace(Node* target, Node* source)
+template<typename Node, template<typename> class Allocator>
+void AVLTree<Node, Allocator>::replace(Node* target, Node* source)
 {
     target->balance_ = source->balance_;
     target->key_ = source->key_;
@@ -522,7 +509,7 @@ void AVLTree<Node>::replace(Node* target, Node* source)
         source->right_->parent_ = target;
     }
 
-    delete source;
+    this->allocator_.destroy(source);
 }
 
 #endif // AVTREE_CPP
@@ -65,21 +65,25 @@ struct AVLNode
     }
 };
 
-template<typename Node>
-class AVLTree : public BinarySearchTree<Node>
+template<typename Node, template<typename> class Allocator = NodeAllocator>
+class AVLTree : public BinarySearchTree<Node, Allocator>
 {
 public:
     using key_type = typename Node::key_type;
     using mapped_type = typename Node::mapped_type;
     using value_type = std::pair<const key_type, mapped_type>;
-    using size_type = typename BinarySearchTree<Node>::size_type;
+    using size_type = typename BinarySearchTree<Node, Allocator>::size_type;
     using node_type = Node;
 
     AVLTree();
+    template<typename ForwardIt>
+    AVLTree(ForwardIt first, ForwardIt last);
     virtual ~AVLTree();
 
-    virtual bool insert(const value_type& value);
-    virtual size_type erase(const key_type& key);
+protected:
+    virtual void setBulkLoadBalance(Node* node, const BulkLoadShape& shape);
+    virtual Node* insertAt(Node* parent, const key_type& key, const mapped_type& value);
+    virtual void eraseNode(Node* node);
 
 private:
     void insertBalance(Node* node, int balance);
@@ -11,6 +11,9 @@
 #include "binarysearchtree.hh"
 #include <iomanip>
 #include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 #include <windows.h>
 
@@ -41,40 +44,44 @@ inline std::ostream& print_blue(std::ostream &s)
 
 } // namespace
 
-template<typename Node>
-BinarySearchTree<Node>::BinarySearchTree() :
+template<typename Node, template<typename> class Allocator>
+BinarySearchTree<Node, Allocator>::BinarySearchTree() :
     nil_{ new Node{} },
     root_{ nil_ },
-    nodes_{ 0 }
+    nodes_{ 0 },
+    allocator_{}
 {
 }
 
-template<typename Node>
-BinarySearchTree<Node>::~BinarySearchTree()
+template<typename Node, template<typename> class Allocator>
+template<typename ForwardIt>
+BinarySearchTree<Node, Allocator>::BinarySearchTree(ForwardIt first, ForwardIt last) :
+    BinarySearchTree{}
 {
-    auto node{ minimum() };
-    while (node != nil_)
-    {
-        erase(node->key_);
-        node = minimum();
-    }
+    bulkLoad(first, last);
+}
+
+template<typename Node, template<typename> class Allocator>
+BinarySearchTree<Node, Allocator>::~BinarySearchTree()
+{
+    destroyTree(root_);
     delete nil_;
 }
 
-template<typename Node>
-typename BinarySearchTree<Node>::size_type BinarySearchTree<Node>::size() const
+template<typename Node, template<typename> class Allocator>
+typename BinarySearchTree<Node, Allocator>::size_type BinarySearchTree<Node, Allocator>::size() const
 {
     return nodes_;
 }
 
-template<typename Node>
-int BinarySearchTree<Node>::height() const
+template<typename Node, template<typename> class Allocator>
+int BinarySearchTree<Node, Allocator>::height() const
 {
     return height(root_);
 }
 
-template<typename Node>
-int BinarySearchTree<Node>::height(Node* node) const
+template<typename Node, template<typename> class Allocator>
+int BinarySearchTree<Node, Allocator>::height(Node* node) const
 {
     if (node == nil_)
     {
@@ -124,28 +131,24 @@ int BinarySearchTree<Node>::height(Node* node) const
     return hMax - hMin;
 }
 
-template<typename Node>
-void BinarySearchTree<Node>::clear()
+template<typename Node, template<typename> class Allocator>
+void BinarySearchTree<Node, Allocator>::clear()
 {
-    auto node{ minimum() };
-    while (node != nil_)
-    {
-        erase(node->key_);
-        node = minimum();
-    }
+    destroyTree(root_);
+    allocator_.clear();
 
     root_ = nil_;
     nodes_ = 0;
 }
 
-template<typename Node>
-Node* BinarySearchTree<Node>::maximum() const
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::maximum() const
 {
     return maximum(root_);
 }
 
-template<typename Node>
-Node* BinarySearchTree<Node>::maximum(Node* node) const
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::maximum(Node* node) const
 {
     if (node == nil_)
     {
@@ -160,14 +163,14 @@ Node* BinarySearchTree<Node>::maximum(Node* node) const
     return x;
 }
 
-template<typename Node>
-Node* BinarySearchTree<Node>::minimum() const
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::minimum() const
 {
     return minimum(root_);
 }
 
-template<typename Node>
-Node* BinarySearchTree<Node>::minimum(Node* node) const
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::minimum(Node* node) const
 {
     if (node == nil_)
     {
@@ -182,8 +185,8 @@ Node* BinarySearchTree<Node>::minimum(Node* node) const
     return x;
 }
 
-template<typename Node>
-Node* BinarySearchTree<Node>::successor(Node* node) const
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::successor(Node* node) const
 {
     if (node == nil_)
     {
@@ -205,8 +208,8 @@ Node* BinarySearchTree<Node>::successor(Node* node) const
     return y;
 }
 
-template<typename Node>
-Node* BinarySearchTree<Node>::predecessor(Node* node) const
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::predecessor(Node* node) const
 {
     if (node == nil_)
     {
@@ -228,8 +231,8 @@ Node* BinarySearchTree<Node>::predecessor(Node* node) const
     return y;
 }
 
-template<typename Node>
-bool BinarySearchTree<Node>::isInTree(Node* node) const
+template<typename Node, template<typename> class Allocator>
+bool BinarySearchTree<Node, Allocator>::isInTree(Node* node) const
 {
     if (node == nil_ or root_ == nil_)
     {
@@ -249,8 +252,8 @@ bool BinarySearchTree<Node>::isInTree(Node* node) const
     return false;
 }
 
-template<typename Node>
-Node* BinarySearchTree<Node>::find(const key_type& key) const
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::find(const key_type& key) const
 {
     auto x{ root_ };
     while (x != nil_)
@@ -271,8 +274,8 @@ Node* BinarySearchTree<Node>::find(const key_type& key) const
     return x;
 }
 
-template<typename Node>
-bool BinarySearchTree<Node>::insert(const value_type& value)
+template<typename Node, template<typename> class Allocator>
+bool BinarySearchTree<Node, Allocator>::insert(const value_type& value)
 {
     Node* x{ root_ };
     Node* parent{ nil_ };
@@ -295,15 +298,115 @@ bool BinarySearchTree<Node>::insert(const value_type& value)
         }
     }
 
+    insertAt(parent, value.first, value.second);
+    return true;
+}
+
+template<typename Node, template<typename> class Allocator>
+typename BinarySearchTree<Node, Allocator>::size_type BinarySearchTree<Node, Allocator>::erase(const key_type& key)
+{
+    auto node{ find(key) };
+    if (node == nil_)
+    {
+        return 0;
+    }
+
+    eraseNode(node);
+    return 1;
+}
+
+template<typename Node, template<typename> class Allocator>
+template<typename ForwardIt>
+typename BinarySearchTree<Node, Allocator>::size_type BinarySearchTree<Node, Allocator>::insertBatch(ForwardIt first, ForwardIt last)
+{
+    std::vector<ForwardIt> batch;
+    for (auto iter{ first }; iter != last; ++iter)
+    {
+        batch.push_back(iter);
+    }
+    // A stable sort keeps the first one of equal keys in front, like
+    // inserting the values one by one would
+    std::stable_sort(batch.begin(), batch.end(),
+        [](const ForwardIt& a, const ForwardIt& b)
+        {
+            return (*a).first < (*b).first;
+        });
+
+    size_type inserted{ 0 };
+    Node* finger{ nil_ };
+    for (const auto& iter : batch)
+    {
+        const auto& key{ (*iter).first };
+
+        Node* x{ (finger != nil_) ? climbTowards(finger, key) : root_ };
+        Node* parent{ nil_ };
+        while (x != nil_ and (key < x->key_ or x->key_ < key))
+        {
+            parent = x;
+            x = (key < x->key_) ? x->left_ : x->right_;
+        }
+
+        if (x != nil_)
+        {
+            // Key already exists in the tree
+            finger = x;
+        }
+        else
+        {
+            finger = insertAt(parent, key, (*iter).second);
+            ++inserted;
+        }
+    }
+
+    return inserted;
+}
+
+template<typename Node, template<typename> class Allocator>
+template<typename InputIt>
+typename BinarySearchTree<Node, Allocator>::size_type BinarySearchTree<Node, Allocator>::eraseBatch(InputIt first, InputIt last)
+{
+    std::vector<key_type> keys(first, last);
+    std::sort(keys.begin(), keys.end());
+
+    size_type erased{ 0 };
+    Node* finger{ nil_ };
+    for (const auto& key : keys)
+    {
+        if (root_ == nil_)
+        {
+            break;
+        }
+
+        Node* x{ (finger != nil_) ? climbTowards(finger, key) : root_ };
+        Node* parent{ nil_ };
+        while (x != nil_ and (key < x->key_ or x->key_ < key))
+        {
+            parent = x;
+            x = (key < x->key_) ? x->left_ : x->right_;
+        }
+
+        if (x == nil_)
+        {
+            finger = parent;
+        }
+        else
+        {
+            // The parent of the erased node stays in the tree
+            finger = x->parent_;
+            eraseNode(x);
+            ++erased;
+        }
+    }
+
+    return erased;
+}
+
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::insertAt(Node* parent, const key_type& key, const mapped_type& value)
+{
     Node* node{
-        new Node{ value.first, value.second,
-                  parent, nil_, nil_ } };
-//    Node* node{ new Node{} };
-//    node->key_ = value.first;
-//    node->value_ = value.second;
-//    node->parent_ = parent;
-//    node->left_ = nil_;
-//    node->right_ = nil_;
+        allocator_.create(key, value,
+                          parent, nil_, nil_) };
 
     if (parent == nil_)
     {
@@ -319,18 +422,12 @@ bool BinarySearchTree<Node>::insert(const value_type& value)
     }
     ++nodes_;
 
-    return true;
+    return node;
 }
 
-template<typename Node>
-typename BinarySearchTree<Node>::size_type BinarySearchTree<Node>::erase(const key_type& key)
+template<typename Node, template<typename> class Allocator>
+void BinarySearchTree<Node, Allocator>::eraseNode(Node* node)
 {
-    auto node{ find(key) };
-    if (node == nil_)
-    {
-        return 0;
-    }
-
     if (node->left_ == nil_)
     {
         transplant(node, node->right_);
@@ -353,13 +450,95 @@ typename BinarySearchTree<Node>::size_type BinarySearchTree<Node>::erase(const k
         y->left_->parent_ = y;
     }
 
-    delete node;
+    allocator_.destroy(node);
     --nodes_;
-    return 1;
 }
 
-template<typename Node>
-void BinarySearchTree<Node>::transplant(Node* u, Node* v)
+template<typename Node, template<typename> class Allocator>
+Node* BinarySearchTree<Node, Allocator>::climbTowards(Node* node, const key_type& key) const
+{
+    // lowOk and highOk tell whether the key is known to be above the lower
+    // bound and below the upper bound of the subtree of node. The bounds are
+    // the keys of the nearest ancestors on the left and on the right.
+    bool lowOk{ node->key_ < key };
+    bool highOk{ key < node->key_ };
+
+    while (node != root_ and (lowOk or highOk))
+    {
+        Node* parent{ node->parent_ };
+        bool parentLowOk{ parent->key_ < key };
+        bool parentHighOk{ key < parent->key_ };
+
+        if (node == parent->left_ ? (parentHighOk and lowOk) : (parentLowOk and highOk))
+        {
+            return node;
+        }
+
+        node = parent;
+        lowOk = parentLowOk;
+        highOk = parentHighOk;
+    }
+
+    return node;
+}
+
+template<typename Node, template<typename> class Allocator>
+template<typename ForwardIt>
+void BinarySearchTree<Node, Allocator>::bulkLoad(ForwardIt first, ForwardIt last)
+{
+    clear();
+
+    auto n{ std::distance(first, last) };
+    root_ = buildBalancedTree(first, n, nil_,
+        [this](const auto& value)
+        {
+            return allocator_.create(value.first, value.second, nil_, nil_, nil_);
+        },
+        [this](Node* node, const BulkLoadShape& shape)
+        {
+            setBulkLoadBalance(node, shape);
+        });
+    nodes_ = static_cast<size_type>(n);
+}
+
+template<typename Node, template<typename> class Allocator>
+void BinarySearchTree<Node, Allocator>::setBulkLoadBalance(Node*, const BulkLoadShape&)
+{
+}
+
+template<typename Node, template<typename> class Allocator>
+void BinarySearchTree<Node, Allocator>::destroyTree(Node* node)
+{
+    if (Allocator<Node>::BULK_RELEASE and std::is_trivially_destructible<Node>::value)
+    {
+        // The allocator releases the nodes in one go
+        return;
+    }
+
+    // The left subtrees are rotated to the right until the node has no left
+    // child, after which it can be deleted. Each rotation moves one node to
+    // the right spine, so the whole teardown takes linear time.
+    Node* x{ node };
+    while (x != nil_)
+    {
+        if (x->left_ != nil_)
+        {
+            Node* y{ x->left_ };
+            x->left_ = y->right_;
+            y->right_ = x;
+            x = y;
+        }
+        else
+        {
+            Node* y{ x->right_ };
+            allocator_.destroy(x);
+            x = y;
+        }
+    }
+}
+
+template<typename Node, template<typename> class Allocator>
+void BinarySearchTree<Node, Allocator>::transplant(Node* u, Node* v)
 {
     if (u == nil_)
     {
@@ -385,8 +564,8 @@ void BinarySearchTree<Node>::transplant(Node* u, Node* v)
     }
 }
 
-template<typename Node>
-void BinarySearchTree<Node>::print() const
+template<typename Node, template<typename> class Allocator>
+void BinarySearchTree<Node, Allocator>::print() const
 {
     const int NODE_WIDTH{ 3 };
     const int NODE_SPACE{ 1 };
@@ -546,8 +725,8 @@ struct ColorStruct<Node, false>
     ColorStruct<Node, false>(...) : color_{ PrintColor::White } {}
 };
 
-template<typename Node>
-PrintColor BinarySearchTree<Node>::getPrintColor(Node* node) const
+template<typename Node, template<typename> class Allocator>
+PrintColor BinarySearchTree<Node, Allocator>::getPrintColor(Node* node) const
 {
     ColorStruct<Node, Has_color<Node>()> colorStruct{ node };
     return colorStruct.color_;
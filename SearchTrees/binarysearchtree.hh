@@ -8,6 +8,8 @@
 #ifndef BINARYSEARCHTREE_HH
 #define BINARYSEARCHTREE_HH
 
+#include "bulkload.hh"
+#include "nodeallocator.hh"
 #include <utility>
 
 enum class PrintColor
@@ -43,7 +45,7 @@ struct TreeNode
     {}
 };
 
-template<typename Node>
+template<typename Node, template<typename> class Allocator = NodeAllocator>
 class BinarySearchTree
 {
 public:
@@ -54,6 +56,9 @@ public:
     using node_type = Node;
 
     BinarySearchTree();
+    // Builds a balanced tree from the values in [first, last), see bulkLoad
+    template<typename ForwardIt>
+    BinarySearchTree(ForwardIt first, ForwardIt last);
     virtual ~BinarySearchTree();
 
     virtual size_type size() const;
@@ -73,12 +78,29 @@ public:
     virtual bool insert(const value_type& value);
     virtual size_type erase(const key_type& key);
 
+    // Inserts the values in [first, last) in the order of their keys. Each
+    // search starts from the previously inserted node and climbs only as high
+    // as needed, so neighbouring keys share their common path from the root.
+    // Returns the number of inserted values.
+    template<typename ForwardIt>
+    size_type insertBatch(ForwardIt first, ForwardIt last);
+    // Erases the keys in [first, last) in sorted order in the same manner.
+    // Returns the number of erased keys.
+    template<typename InputIt>
+    size_type eraseBatch(InputIt first, InputIt last);
+
+    // Replaces the contents of the tree with the values in [first, last) in
+    // linear time. The keys must be in strictly increasing order.
+    template<typename ForwardIt>
+    void bulkLoad(ForwardIt first, ForwardIt last);
+
     virtual void print() const;
 
 protected:
     Node* nil_;
     Node* root_;
     size_type nodes_;
+    Allocator<Node> allocator_;
 
     virtual int height(Node* node) const;
     virtual Node* maximum(Node* node) const;
@@ -86,6 +108,22 @@ protected:
 
     PrintColor getPrintColor(Node* node) const;
 
+    // Creates a node for the key and value as a child of parent, where the
+    // search for the key ended, and rebalances the tree. Returns the new node.
+    virtual Node* insertAt(Node* parent, const key_type& key, const mapped_type& value);
+    // Removes the node from the tree and rebalances the tree
+    virtual void eraseNode(Node* node);
+
+    // Returns the lowest ancestor of node (or node itself) whose subtree
+    // would contain the key. The search for the key can be started from it.
+    Node* climbTowards(Node* node, const key_type& key) const;
+
+    // Sets the balance information of a node created by bulkLoad
+    virtual void setBulkLoadBalance(Node* node, const BulkLoadShape& shape);
+
+    // Deletes the nodes of the given subtree without any rebalancing
+    void destroyTree(Node* node);
+
 private:
     void transplant(Node* u, Node* v);
 };
@@ -1,55 +1,90 @@
-#ifndef BSTTREE_HH
-#define BSTTREE_HH
-
-#include "bstnode.hh"
-#include <utility>
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-class BSTTree
-{
-public:
-    using key_type = Key;
-    using mapped_type = Value;
-    using balancer_type = Balancer<Key, Value>;
-    using value_type = std::pair<const key_type, mapped_type>;
-    using node_type = BSTNode<Key, Value, typename balancer_type::balance_type>;
-    using size_type = unsigned int;
-
-    BSTTree();
-    ~BSTTree();
-
-    size_type size() const;
-    int height() const;
-
-    void clear();
-
-    node_type* maximum() const;
-    node_type* minimum() const;
-
-    node_type* successor(node_type* node) const;
-    node_type* predecessor(node_type* node) const;
-
-    bool isInTree(node_type* node) const;
-
-    node_type* find(const key_type& key);
-    bool insert(const value_type& value);
-    size_type erase(const key_type& key);
-
-    void print() const;
-
-private:
-    node_type* nil_;
-    node_type* root_;
-    size_type nodes_;
-    balancer_type balancer_;
-
-    int height(node_type* node) const;
-    node_type* maximum(node_type* node) const;
-    node_type* minimum(node_type* node) const;
-
-    void transplant(node_type* u, node_type* v);
-};
-
-#include "bsttree_template.cpp"
-
-#endif // BSTTREE_HH
+#ifndef BSTTREE_HH
+#define BSTTREE_HH
+
+#include "bstnode.hh"
+#include "bulkload.hh"
+#include "nodeallocator.hh"
+#include <utility>
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer,
+          template<typename N> class Allocator = NodeAllocator>
+class BSTTree
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using balancer_type = Balancer<Key, Value>;
+    using value_type = std::pair<const key_type, mapped_type>;
+    using node_type = BSTNode<Key, Value, typename balancer_type::balance_type>;
+    using size_type = unsigned int;
+    using allocator_type = Allocator<node_type>;
+
+    BSTTree();
+    // Builds a balanced tree from the values in [first, last), see bulkLoad
+    template<typename ForwardIt>
+    BSTTree(ForwardIt first, ForwardIt last);
+    ~BSTTree();
+
+    size_type size() const;
+    int height() const;
+
+    void clear();
+
+    node_type* maximum() const;
+    node_type* minimum() const;
+
+    node_type* successor(node_type* node) const;
+    node_type* predecessor(node_type* node) const;
+
+    bool isInTree(node_type* node) const;
+
+    node_type* find(const key_type& key);
+    bool insert(const value_type& value);
+    size_type erase(const key_type& key);
+
+    // Inserts the values in [first, last) in the order of their keys. Each
+    // search starts from the previously inserted node and climbs only as high
+    // as needed, so neighbouring keys share their common path from the root.
+    // Returns the number of inserted values.
+    template<typename ForwardIt>
+    size_type insertBatch(ForwardIt first, ForwardIt last);
+    // Erases the keys in [first, last) in sorted order in the same manner.
+    // Returns the number of erased keys.
+    template<typename InputIt>
+    size_type eraseBatch(InputIt first, InputIt last);
+
+    // Replaces the contents of the tree with the values in [first, last) in
+    // linear time. The keys must be in strictly increasing order.
+    template<typename ForwardIt>
+    void bulkLoad(ForwardIt first, ForwardIt last);
+
+    void print() const;
+
+private:
+    friend balancer_type;
+
+    node_type* nil_;
+    node_type* root_;
+    size_type nodes_;
+    balancer_type balancer_;
+    allocator_type allocator_;
+
+    int height(node_type* node) const;
+    node_type* maximum(node_type* node) const;
+    node_type* minimum(node_type* node) const;
+
+    // Deletes the nodes of the given subtree without any rebalancing
+    void destroyTree(node_type* node);
+    // Creates a node for the key and value as a child of parent, where the
+    // search for the key ended, and lets the balancer rebalance the tree
+    node_type* insertAt(node_type* parent, const key_type& key, const mapped_type& value);
+    void eraseNode(node_type* node);
+    // Returns the lowest ancestor of node (or node itself) whose subtree
+    // would contain the key
+    node_type* climbTowards(node_type* node, const key_type& key) const;
+    void transplant(node_type* u, node_type* v);
+};
+
+#include "bsttree_template.cpp"
+
+#endif // BSTTREE_HH
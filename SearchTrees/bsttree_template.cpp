@@ -1,462 +1,644 @@
-#ifndef BSTTREE_TEMPLATE_CPP
-#define BSTTREE_TEMPLATE_CPP
-
-#include "bsttree.hh"
-#include <iomanip>
-#include <iostream>
-#include <vector>
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-BSTTree<Key, Value, Balancer>::BSTTree() :
-    nil_{ new node_type{} },
-    root_{ nil_ },
-    nodes_{ 0 },
-    balancer_{ Balancer<Key, Value>(this) }
-{
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-BSTTree<Key, Value, Balancer>::~BSTTree()
-{
-    auto node{ minimum() };
-    while (node != nil_)
-    {
-        erase(node->key_);
-        node = minimum();
-    }
-    delete nil_;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::size_type BSTTree<Key, Value, Balancer>::size() const
-{
-    return nodes_;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-int BSTTree<Key, Value, Balancer>::height() const
-{
-    return height(root_);
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-void BSTTree<Key, Value, Balancer>::clear()
-{
-    auto node{ minimum() };
-    while (node != nil_)
-    {
-        erase(node->key_);
-        node = minimum();
-    }
-
-    root_ = nil_;
-    nodes_ = 0;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::node_type* BSTTree<Key, Value, Balancer>::maximum() const
-{
-    return maximum(root_);
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::node_type* BSTTree<Key, Value, Balancer>::minimum() const
-{
-    return minimum(root_);
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::node_type* BSTTree<Key, Value, Balancer>::successor(node_type* node) const
-{
-    if (node == nil_)
-    {
-        return nil_;
-    }
-
-    if (node->right_ != nil_)
-    {
-        return minimum(node->right_);
-    }
-
-    auto x{ node };
-    auto y{ x->parent_ };
-    while (y != nil_ and x == y->right_)
-    {
-        x = y;
-        y = y->parent_;
-    }
-    return y;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::node_type* BSTTree<Key, Value, Balancer>::predecessor(node_type* node) const
-{
-    if (node == nil_)
-    {
-        return nil_;
-    }
-
-    if (node->left_ != nil_)
-    {
-        return maximum(node->left_);
-    }
-
-    auto x{ node };
-    auto y{ x->parent_ };
-    while (y != nil_ and x == y->left_)
-    {
-        x = y;
-        y = y->parent_;
-    }
-    return y;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-bool BSTTree<Key, Value, Balancer>::isInTree(node_type* node) const
-{
-    if (node == nil_ or root_ == nil_)
-    {
-        return false;
-    }
-
-    auto x{ node };
-    while (x != nil_)
-    {
-        if (x == root_)
-        {
-            return true;
-        }
-        x = x->parent_;
-    }
-
-    return false;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::node_type* BSTTree<Key, Value, Balancer>::find(const key_type& key)
-{
-    auto x{ root_ };
-    while (x != nil_)
-    {
-        if (key < x->key_)
-        {
-            x = x->left_;
-        }
-        else if (x->key_ < key)
-        {
-            x = x->right_;
-        }
-        else
-        {
-            return x;
-        }
-    }
-
-    balancer_.balanceAfterFind(x);
-    return x;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-bool BSTTree<Key, Value, Balancer>::insert(const value_type& value)
-{
-    auto x{ root_ };
-    auto parent{ nil_ };
-
-    while (x != nil_)
-    {
-        parent = x;
-        if (value.first < x->key_)
-        {
-            x = x->left_;
-        }
-        else if (x->key_ < value.first)
-        {
-            x = x->right_;
-        }
-        else
-        {
-            // Key alreydy exists in the tree
-            return false;
-        }
-    }
-
-    node_type* node
-    {
-        new node_type{ value.first, value.second,
-                       balancer_type::getDefaultBalance(),
-                       parent, nil_, nil_ }
-    };
-
-    if (parent == nil_)
-    {
-        root_ = node;
-    }
-    else if (node->key_ < parent->key_)
-    {
-        parent->left_ = node;
-    }
-    else
-    {
-        parent->right_ = node;
-    }
-    ++nodes_;
-
-    balancer_.balanceAfterInsert(node);
-    return true;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::size_type BSTTree<Key, Value, Balancer>::erase(const key_type& key)
-{
-    auto node{ find(key) };
-    if (node == nil_)
-    {
-        return 0;
-    }
-
-    if (node->left_ == nil_)
-    {
-        transplant(node, node->right_);
-    }
-    else if (node->right_ == nil_)
-    {
-        transplant(node, node->left_);
-    }
-    else
-    {
-        node_type* y{ minimum(node->right_) };
-        if (y->parent_ != node)
-        {
-            transplant(y, y->right_);
-            y->right_ = node->right_;
-            y->right_->parent_ = y;
-        }
-        transplant(node, y);
-        y->left_ = node->left_;
-        y->left_->parent_ = y;
-    }
-
-    balancer_.balanceAfterErase(node);
-    delete node;
-    --nodes_;
-    return 1;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-void BSTTree<Key, Value, Balancer>::print() const
-{
-    const int NODE_WIDTH{ 3 };
-    const int NODE_SPACE{ 1 };
-
-    std::vector<node_type*> nodeList;
-    int h{ height() };
-    for (int level{ 0 }; level <= h; ++level)
-    {
-        std::vector<node_type*> nodeRow;
-
-        if (level == 0)
-        {
-            nodeRow.push_back(root_);
-        }
-        else
-        {
-            for (unsigned int i{ 0 }; i < nodeList.size(); ++i)
-            {
-                node_type* x{ nodeList[i] };
-                if (x == nil_)
-                {
-                    nodeRow.push_back(nil_);
-                    nodeRow.push_back(nil_);
-                }
-                else
-                {
-                    nodeRow.push_back(x->left_);
-                    nodeRow.push_back(x->right_);
-                }
-            }
-        }
-
-        int factor{ (NODE_WIDTH+NODE_SPACE)/2 };
-        int indent{ factor * ((1 << (h - level)) - 1) };
-
-        if (level > 0)
-        {
-            bool left{ true };
-            for (unsigned int i{ 0 }; i < nodeRow.size(); ++i)
-            {
-
-                if (i > 0)
-                {
-                    std::cout << std::setw(NODE_SPACE) << " ";
-                }
-                if (indent > 0)
-                {
-                    std::cout << std::setw(indent) << " ";
-                }
-                std::cout << std::setw(NODE_WIDTH);
-                if (nodeRow[i] != nil_)
-                {
-                    if (left)
-                    {
-                        std::cout << std::right << "/";
-                    }
-                    else
-                    {
-                        std::cout << std::left << "\\";
-                    }
-                }
-                else
-                {
-                    std::cout << " ";
-                }
-                if (i < nodeRow.size() - 1 and indent > 0)
-                {
-                    std::cout << std::setw(indent) << " ";
-                }
-
-                left = not left;
-            }
-            std::cout << std::endl;
-        }
-
-        for (unsigned int i{ 0 }; i < nodeRow.size(); ++i)
-        {
-            if (i > 0)
-            {
-                std::cout << std::setw(NODE_SPACE) << " ";
-            }
-            if (indent > 0)
-            {
-                std::cout << std::setw(indent) << " ";
-            }
-            std::cout << std::setw(NODE_WIDTH) << std::right;
-            if (nodeRow[i] != nil_)
-            {
-                std::cout << nodeRow[i]->key_;
-            }
-            else
-            {
-                std::cout << " ";
-            }
-            if (i + 1 < nodeRow.size() and indent > 0)
-            {
-                std::cout << std::setw(indent) << " ";
-            }
-        }
-        std::cout << std::endl;
-
-        nodeList = nodeRow;
-    }
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-int BSTTree<Key, Value, Balancer>::height(node_type* node) const
-{
-    if (node == nil_)
-    {
-        return -1;
-    }
-
-    int h{ 0 };
-    int hMin{ 0 };
-    int hMax{ 0 };
-
-    auto x{ minimum() };
-    while (x != nil_)
-    {
-        if (x->right_ != nil_)
-        {
-            x = x->right_;
-            --h;
-            while (x->left_ != nil_)
-            {
-                x = x->left_;
-                --h;
-            }
-        }
-        else
-        {
-            auto y{ x->parent_ };
-            while (y != nil_ and x == y->right_)
-            {
-                x = y;
-                y = y->parent_;
-                ++h;
-            }
-            x = y;
-            ++h;
-        }
-
-        if (x != nil_ and h > hMax)
-        {
-            hMax = h;
-        }
-        if (x != nil_ and h < hMin)
-        {
-            hMin = h;
-        }
-    }
-
-    return hMax - hMin;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::node_type* BSTTree<Key, Value, Balancer>::maximum(node_type* node) const
-{
-    if (node == nil_)
-    {
-        return nil_;
-    }
-
-    auto x{ node };
-    while (x->right_ != nil_)
-    {
-        x = x->right_;
-    }
-    return x;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-typename BSTTree<Key, Value, Balancer>::node_type* BSTTree<Key, Value, Balancer>::minimum(node_type* node) const
-{
-    if (node == nil_)
-    {
-        return nil_;
-    }
-
-    auto x{ node };
-    while (x->left_ != nil_)
-    {
-        x = x->left_;
-    }
-    return x;
-}
-
-template <typename Key, typename Value, template<typename K, typename V> class Balancer>
-void BSTTree<Key, Value, Balancer>::transplant(node_type* u, node_type* v)
-{
-    if (u == nil_)
-    {
-        return;
-    }
-
-    if (u->parent_ == nil_)
-    {
-        root_ = v;
-    }
-    else if (u == u->parent_->left_)
-    {
-        u->parent_->left_ = v;
-    }
-    else
-    {
-        u->parent_->right_ = v;
-    }
-
-    if (v != nil_)
-    {
-        v->parent_ = u->parent_;
-    }
-}
-
-#endif // BSTTREE_TEMPLATE_CPP
+#ifndef BSTTREE_TEMPLATE_CPP
+#define BSTTREE_TEMPLATE_CPP
+
+#include "bsttree.hh"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+BSTTree<Key, Value, Balancer, Allocator>::BSTTree() :
+    nil_{ new node_type{} },
+    root_{ nil_ },
+    nodes_{ 0 },
+    balancer_{},
+    allocator_{}
+{
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+template<typename ForwardIt>
+BSTTree<Key, Value, Balancer, Allocator>::BSTTree(ForwardIt first, ForwardIt last) :
+    BSTTree{}
+{
+    bulkLoad(first, last);
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+BSTTree<Key, Value, Balancer, Allocator>::~BSTTree()
+{
+    destroyTree(root_);
+    delete nil_;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::size_type BSTTree<Key, Value, Balancer, Allocator>::size() const
+{
+    return nodes_;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+int BSTTree<Key, Value, Balancer, Allocator>::height() const
+{
+    return height(root_);
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+void BSTTree<Key, Value, Balancer, Allocator>::clear()
+{
+    destroyTree(root_);
+    allocator_.clear();
+
+    root_ = nil_;
+    nodes_ = 0;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::maximum() const
+{
+    return maximum(root_);
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::minimum() const
+{
+    return minimum(root_);
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::successor(node_type* node) const
+{
+    if (node == nil_)
+    {
+        return nil_;
+    }
+
+    if (node->right_ != nil_)
+    {
+        return minimum(node->right_);
+    }
+
+    auto x{ node };
+    auto y{ x->parent_ };
+    while (y != nil_ and x == y->right_)
+    {
+        x = y;
+        y = y->parent_;
+    }
+    return y;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::predecessor(node_type* node) const
+{
+    if (node == nil_)
+    {
+        return nil_;
+    }
+
+    if (node->left_ != nil_)
+    {
+        return maximum(node->left_);
+    }
+
+    auto x{ node };
+    auto y{ x->parent_ };
+    while (y != nil_ and x == y->left_)
+    {
+        x = y;
+        y = y->parent_;
+    }
+    return y;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+bool BSTTree<Key, Value, Balancer, Allocator>::isInTree(node_type* node) const
+{
+    if (node == nil_ or root_ == nil_)
+    {
+        return false;
+    }
+
+    auto x{ node };
+    while (x != nil_)
+    {
+        if (x == root_)
+        {
+            return true;
+        }
+        x = x->parent_;
+    }
+
+    return false;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::find(const key_type& key)
+{
+    auto x{ root_ };
+    while (x != nil_)
+    {
+        if (key < x->key_)
+        {
+            x = x->left_;
+        }
+        else if (x->key_ < key)
+        {
+            x = x->right_;
+        }
+        else
+        {
+            return x;
+        }
+    }
+
+    balancer_.balanceAfterFind(*this, x);
+    return x;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+bool BSTTree<Key, Value, Balancer, Allocator>::insert(const value_type& value)
+{
+    auto x{ root_ };
+    auto parent{ nil_ };
+
+    while (x != nil_)
+    {
+        parent = x;
+        if (value.first < x->key_)
+        {
+            x = x->left_;
+        }
+        else if (x->key_ < value.first)
+        {
+            x = x->right_;
+        }
+        else
+        {
+            // Key alreydy exists in the tree
+            return false;
+        }
+    }
+
+    insertAt(parent, value.first, value.second);
+    return true;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::size_type BSTTree<Key, Value, Balancer, Allocator>::erase(const key_type& key)
+{
+    auto node{ find(key) };
+    if (node == nil_)
+    {
+        return 0;
+    }
+
+    eraseNode(node);
+    return 1;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+template<typename ForwardIt>
+typename BSTTree<Key, Value, Balancer, Allocator>::size_type BSTTree<Key, Value, Balancer, Allocator>::insertBatch(ForwardIt first, ForwardIt last)
+{
+    std::vector<ForwardIt> batch;
+    for (auto iter{ first }; iter != last; ++iter)
+    {
+        batch.push_back(iter);
+    }
+    // A stable sort keeps the first one of equal keys in front, like
+    // inserting the values one by one would
+    std::stable_sort(batch.begin(), batch.end(),
+        [](const ForwardIt& a, const ForwardIt& b)
+        {
+            return (*a).first < (*b).first;
+        });
+
+    size_type inserted{ 0 };
+    node_type* finger{ nil_ };
+    for (const auto& iter : batch)
+    {
+        const auto& key{ (*iter).first };
+
+        node_type* x{ (finger != nil_) ? climbTowards(finger, key) : root_ };
+        node_type* parent{ nil_ };
+        while (x != nil_ and (key < x->key_ or x->key_ < key))
+        {
+            parent = x;
+            x = (key < x->key_) ? x->left_ : x->right_;
+        }
+
+        if (x != nil_)
+        {
+            // Key already exists in the tree
+            finger = x;
+        }
+        else
+        {
+            finger = insertAt(parent, key, (*iter).second);
+            ++inserted;
+        }
+    }
+
+    return inserted;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+template<typename InputIt>
+typename BSTTree<Key, Value, Balancer, Allocator>::size_type BSTTree<Key, Value, Balancer, Allocator>::eraseBatch(InputIt first, InputIt last)
+{
+    std::vector<key_type> keys(first, last);
+    std::sort(keys.begin(), keys.end());
+
+    size_type erased{ 0 };
+    node_type* finger{ nil_ };
+    for (const auto& key : keys)
+    {
+        if (root_ == nil_)
+        {
+            break;
+        }
+
+        node_type* x{ (finger != nil_) ? climbTowards(finger, key) : root_ };
+        node_type* parent{ nil_ };
+        while (x != nil_ and (key < x->key_ or x->key_ < key))
+        {
+            parent = x;
+            x = (key < x->key_) ? x->left_ : x->right_;
+        }
+
+        if (x == nil_)
+        {
+            finger = parent;
+        }
+        else
+        {
+            // The parent of the erased node stays in the tree
+            finger = x->parent_;
+            eraseNode(x);
+            ++erased;
+        }
+    }
+
+    return erased;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::insertAt(node_type* parent, const key_type& key, const mapped_type& value)
+{
+    node_type* node
+    {
+        allocator_.create(key, value,
+                          balancer_type::getDefaultBalance(),
+                          parent, nil_, nil_)
+    };
+
+    if (parent == nil_)
+    {
+        root_ = node;
+    }
+    else if (node->key_ < parent->key_)
+    {
+        parent->left_ = node;
+    }
+    else
+    {
+        parent->right_ = node;
+    }
+    ++nodes_;
+
+    balancer_.balanceAfterInsert(*this, node);
+    return node;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+void BSTTree<Key, Value, Balancer, Allocator>::eraseNode(node_type* node)
+{
+    if (node->left_ == nil_)
+    {
+        transplant(node, node->right_);
+    }
+    else if (node->right_ == nil_)
+    {
+        transplant(node, node->left_);
+    }
+    else
+    {
+        node_type* y{ minimum(node->right_) };
+        if (y->parent_ != node)
+        {
+            transplant(y, y->right_);
+            y->right_ = node->right_;
+            y->right_->parent_ = y;
+        }
+        transplant(node, y);
+        y->left_ = node->left_;
+        y->left_->parent_ = y;
+    }
+
+    balancer_.balanceAfterErase(*this, node);
+    allocator_.destroy(node);
+    --nodes_;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::climbTowards(node_type* node, const key_type& key) const
+{
+    // lowOk and highOk tell whether the key is known to be above the lower
+    // bound and below the upper bound of the subtree of node. The bounds are
+    // the keys of the nearest ancestors on the left and on the right.
+    bool lowOk{ node->key_ < key };
+    bool highOk{ key < node->key_ };
+
+    while (node != root_ and (lowOk or highOk))
+    {
+        node_type* parent{ node->parent_ };
+        bool parentLowOk{ parent->key_ < key };
+        bool parentHighOk{ key < parent->key_ };
+
+        if (node == parent->left_ ? (parentHighOk and lowOk) : (parentLowOk and highOk))
+        {
+            return node;
+        }
+
+        node = parent;
+        lowOk = parentLowOk;
+        highOk = parentHighOk;
+    }
+
+    return node;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+template<typename ForwardIt>
+void BSTTree<Key, Value, Balancer, Allocator>::bulkLoad(ForwardIt first, ForwardIt last)
+{
+    clear();
+
+    auto n{ std::distance(first, last) };
+    root_ = buildBalancedTree(first, n, nil_,
+        [this](const auto& value)
+        {
+            return allocator_.create(value.first, value.second,
+                                     balancer_type::getDefaultBalance(),
+                                     nil_, nil_, nil_);
+        },
+        [](node_type* node, const BulkLoadShape& shape)
+        {
+            node->balance_ = balancer_type::getBulkLoadBalance(shape);
+        });
+    nodes_ = static_cast<size_type>(n);
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+void BSTTree<Key, Value, Balancer, Allocator>::print() const
+{
+    const int NODE_WIDTH{ 3 };
+    const int NODE_SPACE{ 1 };
+
+    std::vector<node_type*> nodeList;
+    int h{ height() };
+    for (int level{ 0 }; level <= h; ++level)
+    {
+        std::vector<node_type*> nodeRow;
+
+        if (level == 0)
+        {
+            nodeRow.push_back(root_);
+        }
+        else
+        {
+            for (unsigned int i{ 0 }; i < nodeList.size(); ++i)
+            {
+                node_type* x{ nodeList[i] };
+                if (x == nil_)
+                {
+                    nodeRow.push_back(nil_);
+                    nodeRow.push_back(nil_);
+                }
+                else
+                {
+                    nodeRow.push_back(x->left_);
+                    nodeRow.push_back(x->right_);
+                }
+            }
+        }
+
+        int factor{ (NODE_WIDTH+NODE_SPACE)/2 };
+        int indent{ factor * ((1 << (h - level)) - 1) };
+
+        if (level > 0)
+        {
+            bool left{ true };
+            for (unsigned int i{ 0 }; i < nodeRow.size(); ++i)
+            {
+
+                if (i > 0)
+                {
+                    std::cout << std::setw(NODE_SPACE) << " ";
+                }
+                if (indent > 0)
+                {
+                    std::cout << std::setw(indent) << " ";
+                }
+                std::cout << std::setw(NODE_WIDTH);
+                if (nodeRow[i] != nil_)
+                {
+                    if (left)
+                    {
+                        std::cout << std::right << "/";
+                    }
+                    else
+                    {
+                        std::cout << std::left << "\\";
+                    }
+                }
+                else
+                {
+                    std::cout << " ";
+                }
+                if (i < nodeRow.size() - 1 and indent > 0)
+                {
+                    std::cout << std::setw(indent) << " ";
+                }
+
+                left = not left;
+            }
+            std::cout << std::endl;
+        }
+
+        for (unsigned int i{ 0 }; i < nodeRow.size(); ++i)
+        {
+            if (i > 0)
+            {
+                std::cout << std::setw(NODE_SPACE) << " ";
+            }
+            if (indent > 0)
+            {
+                std::cout << std::setw(indent) << " ";
+            }
+            std::cout << std::setw(NODE_WIDTH) << std::right;
+            if (nodeRow[i] != nil_)
+            {
+                std::cout << nodeRow[i]->key_;
+            }
+            else
+            {
+                std::cout << " ";
+            }
+            if (i + 1 < nodeRow.size() and indent > 0)
+            {
+                std::cout << std::setw(indent) << " ";
+            }
+        }
+        std::cout << std::endl;
+
+        nodeList = nodeRow;
+    }
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+int BSTTree<Key, Value, Balancer, Allocator>::height(node_type* node) const
+{
+    if (node == nil_)
+    {
+        return -1;
+    }
+
+    int h{ 0 };
+    int hMin{ 0 };
+    int hMax{ 0 };
+
+    auto x{ minimum() };
+    while (x != nil_)
+    {
+        if (x->right_ != nil_)
+        {
+            x = x->right_;
+            --h;
+            while (x->left_ != nil_)
+            {
+                x = x->left_;
+                --h;
+            }
+        }
+        else
+        {
+            auto y{ x->parent_ };
+            while (y != nil_ and x == y->right_)
+            {
+                x = y;
+                y = y->parent_;
+                ++h;
+            }
+            x = y;
+            ++h;
+        }
+
+        if (x != nil_ and h > hMax)
+        {
+            hMax = h;
+        }
+        if (x != nil_ and h < hMin)
+        {
+            hMin = h;
+        }
+    }
+
+    return hMax - hMin;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::maximum(node_type* node) const
+{
+    if (node == nil_)
+    {
+        return nil_;
+    }
+
+    auto x{ node };
+    while (x->right_ != nil_)
+    {
+        x = x->right_;
+    }
+    return x;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+typename BSTTree<Key, Value, Balancer, Allocator>::node_type* BSTTree<Key, Value, Balancer, Allocator>::minimum(node_type* node) const
+{
+    if (node == nil_)
+    {
+        return nil_;
+    }
+
+    auto x{ node };
+    while (x->left_ != nil_)
+    {
+        x = x->left_;
+    }
+    return x;
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+void BSTTree<Key, Value, Balancer, Allocator>::destroyTree(node_type* node)
+{
+    if (allocator_type::BULK_RELEASE and std::is_trivially_destructible<node_type>::value)
+    {
+        // The allocator releases the nodes in one go
+        return;
+    }
+
+    // The left subtrees are rotated to the right until the node has no left
+    // child, after which it can be deleted. Each rotation moves one node to
+    // the right spine, so the whole teardown takes linear time.
+    node_type* x{ node };
+    while (x != nil_)
+    {
+        if (x->left_ != nil_)
+        {
+            node_type* y{ x->left_ };
+            x->left_ = y->right_;
+            y->right_ = x;
+            x = y;
+        }
+        else
+        {
+            node_type* y{ x->right_ };
+            allocator_.destroy(x);
+            x = y;
+        }
+    }
+}
+
+template <typename Key, typename Value, template<typename K, typename V> class Balancer, template<typename N> class Allocator>
+void BSTTree<Key, Value, Balancer, Allocator>::transplant(node_type* u, node_type* v)
+{
+    if (u == nil_)
+    {
+        return;
+    }
+
+    if (u->parent_ == nil_)
+    {
+        root_ = v;
+    }
+    else if (u == u->parent_->left_)
+    {
+        u->parent_->left_ = v;
+    }
+    else
+    {
+        u->parent_->right_ = v;
+    }
+
+    if (v != nil_)
+    {
+        v->parent_ = u->parent_;
+    }
+}
+
+#endif // BSTTREE_TEMPLATE_CPP
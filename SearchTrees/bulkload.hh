@@ -0,0 +1,119 @@
+// Building perfectly balanced binary search trees from sorted input
+//
+// buildBalancedTree takes n values in sorted order and builds a tree in which
+// the sizes of the two subtrees of every node differ by at most one, the right
+// subtree being the larger one. createNode(value) must return a node for the
+// value. The builder links the nodes together and calls setBalance(node, shape)
+// for every node once both of its subtrees are ready, so that the trees can
+// set their balance information. The whole build takes linear time.
+
+#ifndef BULKLOAD_HH
+#define BULKLOAD_HH
+
+#include <algorithm>
+#include <cstddef>
+
+// The position of a node in a tree built by buildBalancedTree
+//  depth_: the depth of the node, the root is at depth 0
+//  treeHeight_: the height of the whole tree
+//  leftHeight_: the height of the left subtree, -1 if it is empty
+//  rightHeight_: the height of the right subtree, -1 if it is empty
+//  rank_: the number of nodes on the shortest path from the node to nil
+struct BulkLoadShape
+{
+    int depth_;
+    int treeHeight_;
+    int leftHeight_;
+    int rightHeight_;
+    int rank_;
+};
+
+template<typename Node, typename CreateNode, typename SetBalance>
+class BalancedTreeBuilder
+{
+public:
+    BalancedTreeBuilder(Node* nil, int treeHeight,
+                        CreateNode& createNode, SetBalance& setBalance) :
+        nil_{ nil },
+        treeHeight_{ treeHeight },
+        createNode_(createNode),
+        setBalance_(setBalance)
+    {}
+
+    // Builds a subtree from the next n values, sets its height and rank
+    // and returns its root
+    template<typename ForwardIt>
+    Node* build(ForwardIt& iter, std::size_t n, int depth, int& height, int& rank)
+    {
+        if (n == 0)
+        {
+            height = -1;
+            rank = 0;
+            return nil_;
+        }
+
+        BulkLoadShape shape;
+        shape.depth_ = depth;
+        shape.treeHeight_ = treeHeight_;
+
+        int leftRank{ 0 };
+        int rightRank{ 0 };
+        std::size_t leftSize{ (n - 1) / 2 };
+
+        Node* left{ build(iter, leftSize, depth + 1, shape.leftHeight_, leftRank) };
+        Node* node{ createNode_(*iter) };
+        ++iter;
+        Node* right{ build(iter, n - 1 - leftSize, depth + 1, shape.rightHeight_, rightRank) };
+
+        node->left_ = left;
+        node->right_ = right;
+        if (left != nil_)
+        {
+            left->parent_ = node;
+        }
+        if (right != nil_)
+        {
+            right->parent_ = node;
+        }
+
+        shape.rank_ = 1 + std::min(leftRank, rightRank);
+        setBalance_(node, shape);
+
+        height = 1 + std::max(shape.leftHeight_, shape.rightHeight_);
+        rank = shape.rank_;
+        return node;
+    }
+
+private:
+    Node* nil_;
+    int treeHeight_;
+    CreateNode& createNode_;
+    SetBalance& setBalance_;
+};
+
+// Builds a balanced tree from the n values starting from first and returns
+// its root. The parent of the root is set to nil.
+template<typename Node, typename ForwardIt, typename CreateNode, typename SetBalance>
+Node* buildBalancedTree(ForwardIt first, std::size_t n, Node* nil,
+                        CreateNode createNode, SetBalance setBalance)
+{
+    int treeHeight{ -1 };
+    for (std::size_t size{ n }; size > 0; size /= 2)
+    {
+        ++treeHeight;
+    }
+
+    BalancedTreeBuilder<Node, CreateNode, SetBalance> builder{
+        nil, treeHeight, createNode, setBalance };
+
+    int height{ 0 };
+    int rank{ 0 };
+    Node* root{ builder.build(first, n, 0, height, rank) };
+    if (root != nil)
+    {
+        root->parent_ = nil;
+    }
+    return root;
+}
+
+#endif // BULKLOAD_HH
@@ -1,10 +1,15 @@
 // The main program for the binary search tree test
 //
-// Usage of the program: SearchTrees START_VALUE INTERVAL ITERATIONS REPEATS
+// Usage of the program: SearchTrees START_VALUE INTERVAL ITERATIONS REPEATS [OPTIONS]
 //   where START_VALUE = the start value of n in the tests
 //         INTERVAL    = the value by which n is increased in each iterations
 //         ITERATIONS  = how many iterations are run
 //         REPEATS     = how many times the test are repeated
+//   and OPTIONS are
+//         -bulk       = the first insertion phase sorts the values and builds
+//                       the trees with bulkLoad
+//         -batch N    = the values are inserted and deleted in batches of N
+//                       values with insertBatch and eraseBatch
 //
 //   example: SearchTrees 10000 5000 3 2
 //     will run the tests twice with the values of n = 10000, 15000 and 20000
@@ -14,13 +19,35 @@
 #include "treetest.hh"
 #include <iostream>
 #include <stdlib.h>
+#include <string>
 
 int main(int argc, char *argv[])
 {
-    if (argc != 5)
+    TestOptions options{ false, 0 };
+    bool validOptions{ argc >= 5 };
+    for (int i{ 5 }; i < argc; ++i)
+    {
+        std::string option{ argv[i] };
+        if (option == "-bulk")
+        {
+            options.bulkLoad_ = true;
+        }
+        else if (option == "-batch" and i + 1 < argc)
+        {
+            ++i;
+            options.batchSize_ = atoi(argv[i]);
+            validOptions = validOptions and options.batchSize_ > 0;
+        }
+        else
+        {
+            validOptions = false;
+        }
+    }
+
+    if (not validOptions)
     {
         std::cout << "Usage: " << argv[0]
-                  << " START_VALUE INTERVAL ITERATIONS REPEATS"
+                  << " START_VALUE INTERVAL ITERATIONS REPEATS [-bulk] [-batch N]"
                   << std::endl;
         return EXIT_FAILURE;
     }
@@ -38,7 +65,7 @@ int main(int argc, char *argv[])
         testValues.push_back(startValue + i * interval);
     }
 
-    TreeTest trees;
+    TreeTest trees{ options };
     std::vector<TestTime> testTimes;
     for (int i{ 0 }; i < repeats; ++i)
     {
@@ -0,0 +1,148 @@
+// Node allocators for the binary search trees
+//
+// NodeAllocator allocates every node separately with new and delete.
+// NodePool allocates the nodes from larger slabs, recycles the destroyed
+// nodes through a free list and releases all slabs at once in clear().
+//
+// BULK_RELEASE tells whether clear() also releases the memory of the nodes
+// that have not been destroyed. In that case a tree with trivially
+// destructible nodes can skip visiting its nodes when it is cleared.
+
+#ifndef NODEALLOCATOR_HH
+#define NODEALLOCATOR_HH
+
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<typename Node>
+class NodeAllocator
+{
+public:
+    static const bool BULK_RELEASE = false;
+
+    NodeAllocator()
+    {}
+
+    template<typename... Args>
+    Node* create(Args&&... args)
+    {
+        return new Node{ std::forward<Args>(args)... };
+    }
+
+    void destroy(Node* node)
+    {
+        delete node;
+    }
+
+    // Nothing to release, every node has already been deleted in destroy()
+    void clear()
+    {
+    }
+
+private:
+    NodeAllocator(const NodeAllocator&) = delete;
+    NodeAllocator& operator=(const NodeAllocator&) = delete;
+};
+
+template<typename Node>
+class NodePool
+{
+public:
+    // The number of nodes in the first slab, each new slab is twice the size
+    // of the previous one until MAX_SLAB_SIZE is reached
+    static const unsigned int MIN_SLAB_SIZE = 64;
+    static const unsigned int MAX_SLAB_SIZE = 65536;
+    static const bool BULK_RELEASE = true;
+
+    NodePool() :
+        slabs_{},
+        free_{ nullptr },
+        next_{ nullptr },
+        end_{ nullptr },
+        slabSize_{ MIN_SLAB_SIZE }
+    {}
+
+    ~NodePool()
+    {
+        clear();
+    }
+
+    template<typename... Args>
+    Node* create(Args&&... args)
+    {
+        Slot* slot{ free_ };
+        if (slot != nullptr)
+        {
+            free_ = slot->next_;
+        }
+        else
+        {
+            if (next_ == end_)
+            {
+                addSlab();
+            }
+            slot = next_;
+            ++next_;
+        }
+
+        return new (&slot->node_) Node{ std::forward<Args>(args)... };
+    }
+
+    // Destroys the node and puts its memory to the free list
+    void destroy(Node* node)
+    {
+        node->~Node();
+        Slot* slot{ reinterpret_cast<Slot*>(node) };
+        slot->next_ = free_;
+        free_ = slot;
+    }
+
+    // Releases all the slabs at once. The destructors of the nodes that
+    // have not been destroyed are not called.
+    void clear()
+    {
+        for (auto slab : slabs_)
+        {
+            delete[] slab;
+        }
+        slabs_.clear();
+
+        free_ = nullptr;
+        next_ = nullptr;
+        end_ = nullptr;
+        slabSize_ = MIN_SLAB_SIZE;
+    }
+
+private:
+    union Slot
+    {
+        Slot* next_;
+        typename std::aligned_storage<sizeof(Node), alignof(Node)>::type node_;
+    };
+
+    std::vector<Slot*> slabs_;
+    Slot* free_;
+    Slot* next_;
+    Slot* end_;
+    unsigned int slabSize_;
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    void addSlab()
+    {
+        Slot* slab{ new Slot[slabSize_] };
+        slabs_.push_back(slab);
+        next_ = slab;
+        end_ = slab + slabSize_;
+
+        if (slabSize_ < MAX_SLAB_SIZE)
+        {
+            slabSize_ *= 2;
+        }
+    }
+};
+
+#endif // NODEALLOCATOR_HH
@@ -10,44 +10,45 @@
 
 #include "redblacktree.hh"
 
-template<typename Node>
-RedBlackTree<Node>::RedBlackTree() :
-    BinarySearchTree<Node>{}
+template<typename Node, template<typename> class Allocator>
+RedBlackTree<Node, Allocator>::RedBlackTree() :
+    BinarySearchTree<Node, Allocator>{}
 {
 }
 
-template<typename Node>
-RedBlackTree<Node>::~RedBlackTree()
+template<typename Node, template<typename> class Allocator>
+template<typename ForwardIt>
+RedBlackTree<Node, Allocator>::RedBlackTree(ForwardIt first, ForwardIt last) :
+    BinarySearchTree<Node, Allocator>{}
 {
+    this->bulkLoad(first, last);
 }
 
-template<typename Node>
-bool RedBlackTree<Node>::insert(const value_type& value)
+template<typename Node, template<typename> class Allocator>
+RedBlackTree<Node, Allocator>::~RedBlackTree()
 {
-    Node* x{ this->root_ };
-    Node* parent{ this->nil_ };
+}
 
-    while (x != this->nil_)
+template<typename Node, template<typename> class Allocator>
+void RedBlackTree<Node, Allocator>::setBulkLoadBalance(Node* node, const BulkLoadShape& shape)
+{
+    // The nodes on the lowest level are red when the tree has more than one level
+    if (shape.depth_ == shape.treeHeight_ and shape.treeHeight_ > 0)
     {
-        parent = x;
-        if (value.first < x->key_)
-        {
-            x = x->left_;
-        }
-        else if (x->key_ < value.first)
-        {
-            x = x->right_;
-        }
-        else
-        {
-            // Key alreydy exists in the tree
-            return false;
-        }
+        node->color_ = Color::Red;
     }
+    else
+    {
+        node->color_ = Color::Black;
+    }
+}
 
+template<typename Node, template<typename> class Allocator>
+Node* RedBlackTree<Node, Allocator>::insertAt(Node* parent, const key_type& key, const mapped_type& value)
+{
     Node* node{
-        new Node{ value.first, value.second,
-                  parent, this->nil_, this->nil_, Color::Red } };
+        this->allocator_.create(key, value,
+                                parent, this->nil_, this->nil_, Color::Red) };
 
     if (parent == this->nil_)
     {
@@ -65,18 +66,12 @@ bool RedBlackTree<Node>::insert(const value_type& value)
 
     insertFix(node);
 
-    return true;
+    return node;
 }
 
-template<typename Node>
-typename RedBlackTree<Node>::size_type RedBlackTree<Node>::erase(const key_type& key)
+template<typename Node, template<typename> class Allocator>
+void RedBlackTree<Node, Allocator>::eraseNode(Node* node)
 {
-    auto node{ this->find(key) };
-    if (node == this->nil_)
-    {
-        return 0;
-    }
-
     Node* x{ this->nil_ };
     Node* y{ node };
     Color yOriginalColor{ y->color_ };
@@ -113,19 +108,17 @@ typename RedBlackTree<Node>::size_type RedBlackTree<Node>::erase(const key_type&
         y->color_ = node->color_;
     }
 
-    delete node;
+    this->allocator_.destroy(node);
     --this->nodes_;
 
     if (yOriginalColor == Color::Black)
     {
         deleteFix(x);
     }
-
-    return 1;
 }
 
-template<typename Node>
-void RedBlackTree<Node>::rotateLeft(Node* x)
+template<typename Node, template<typename> class Allocator>
+void RedBlackTree<Node, Allocator>::rotateLeft(Node* x)
 {
     Node* y{ x->right_ };
 
@@ -153,8 +146,8 @@ void RedBlackTree<Node>::rotateLeft(Node* x)
     x->parent_ = y;
 }
 
-template<typename Node>
-void RedBlackTree<Node>::rotateRight(Node* x)
+template<typename Node, template<typename> class Allocator>
+void RedBlackTree<Node, Allocator>::rotateRight(Node* x)
 {
     Node* y{ x->left_ };
 
@@ -182,8 +175,8 @@ void RedBlackTree<Node>::rotateRight(Node* x)
     x->parent_ = y;
 }
 
-template<typename Node>
-void RedBlackTree<Node>::insertFix(Node* x)
+template<typename Node, template<typename> class Allocator>
+void RedBlackTree<Node, Allocator>::insertFix(Node* x)
 {
     while (x->parent_->color_ == Color::Red)
     {
@@ -238,8 +231,8 @@ void RedBlackTree<Node>::insertFix(Node* x)
     this->root_->color_ = Color::Black;
 }
 
-template<typename Node>
-void RedBlackTree<Node>::deleteFix(Node* x)
+template<typename Node, template<typename> class Allocator>
+void RedBlackTree<Node, Allocator>::deleteFix(Node* x)
 {
     while (x != this->root_ and x->color_ == Color::Black)
     {
@@ -312,8 +305,8 @@ void RedBlackTree<Node>::deleteFix(Node* x)
     x->color_ = Color::Black;
 }
 
-template<typename Node>
-void RedBlackTree<Node>::transplant(Node* u, Node* v)
+template<typename Node, template<typename> class Allocator>
+void RedBlackTree<Node, Allocator>::transplant(Node* u, Node* v)
 {
     if (u == this->nil_)
     {
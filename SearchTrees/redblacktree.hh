@@ -61,21 +61,25 @@ struct RedBlackNode
     }
 };
 
-template<typename Node>
-class RedBlackTree : public BinarySearchTree<Node>
+template<typename Node, template<typename> class Allocator = NodeAllocator>
+class RedBlackTree : public BinarySearchTree<Node, Allocator>
 {
 public:
     using key_type = typename Node::key_type;
     using mapped_type = typename Node::mapped_type;
     using value_type = std::pair<const key_type, mapped_type>;
-    using size_type = typename BinarySearchTree<Node>::size_type;
+    using size_type = typename BinarySearchTree<Node, Allocator>::size_type;
     using node_type = Node;
 
     RedBlackTree();
+    template<typename ForwardIt>
+    RedBlackTree(ForwardIt first, ForwardIt last);
     virtual ~RedBlackTree();
 
-    virtual bool insert(const value_type& value);
-    virtual size_type erase(const key_type& key);
+protected:
+    virtual void setBulkLoadBalance(Node* node, const BulkLoadShape& shape);
+    virtual Node* insertAt(Node* parent, const key_type& key, const mapped_type& value);
+    virtual void eraseNode(Node* node);
 
 private:
     void rotateLeft(Node* x);
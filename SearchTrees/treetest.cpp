@@ -10,7 +10,8 @@
 #include <iostream>
 #include <string>
 
-TreeTest::TreeTest() :
+TreeTest::TreeTest(const TestOptions& options) :
+    options_(options),
     trees_{}
 {
 }
@@ -28,6 +29,7 @@ std::vector<TestTime> TreeTest::test(int n)
         TestData testData;
         testData.testName = test.name_;
         testData.bst = test.bst_;
+        testData.options = options_;
         generator.getTestValues(n, test.insert_, test.delete_,
                                 testData.insertKeys1, testData.insertKeys2,
                                 testData.searchKeys1, testData.searchKeys2,
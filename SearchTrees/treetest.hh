@@ -40,14 +40,15 @@ const std::vector<Test> TEST_LIST
 class TreeTest
 {
 public:
-    TreeTest();
+    TreeTest(const TestOptions& options);
 
     // Runs the tests with the given value of n
     std::vector<TestTime> test(int n);
 
 private:
-//    std::tuple<rbt_tree, avl_tree, aa_tree, bst_tree, map_tree, tree1> trees_;
-    std::tuple<bst_tree, tree1> trees_;
+    TestOptions options_;
+    std::tuple<rbt_tree, avl_tree, aa_tree, bst_tree, map_tree, tree1,
+               rbt_pool_tree, avl_pool_tree, aa_pool_tree, bst_pool_tree> trees_;
 };
 
 #endif // TREETEST_HH
@@ -3,6 +3,7 @@
 
 #include "timer.hh"
 #include "treetest.hh"
+#include <algorithm>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -60,6 +61,116 @@ int getHeight(const Container& container)
     return heightStruct.height_;
 }
 
+template<typename T>
+struct get_bulk_load_result
+{
+private:
+    using value_type = std::pair<typename T::key_type, typename T::mapped_type>;
+    using iterator = typename std::vector<value_type>::iterator;
+
+    template<typename X>
+    static auto check(X& x) -> decltype(x.bulkLoad(std::declval<iterator>(), std::declval<iterator>()));
+    static substitution_failure check(...);
+public:
+    using type = decltype(check(std::declval<T&>()));
+};
+
+template<typename T>
+struct has_bulk_load : substitution_succeeded<typename get_bulk_load_result<T>::type>
+{};
+
+template<typename T>
+constexpr bool Has_bulk_load()
+{
+    return has_bulk_load<T>::value;
+}
+
+template<typename Container, bool C = Has_bulk_load<Container>()>
+struct BulkLoadStruct
+{
+    template<typename Iterator>
+    static void load(Container& container, Iterator first, Iterator last)
+    {
+        container.bulkLoad(first, last);
+    }
+};
+
+template<typename Container>
+struct BulkLoadStruct<Container, false>
+{
+    template<typename Iterator>
+    static void load(Container& container, Iterator first, Iterator last)
+    {
+        container.clear();
+        for (auto iter{ first }; iter != last; ++iter)
+        {
+            container.insert(*iter);
+        }
+    }
+};
+
+template<typename T>
+struct get_insert_batch_result
+{
+private:
+    using value_type = std::pair<typename T::key_type, typename T::mapped_type>;
+    using iterator = typename std::vector<value_type>::iterator;
+
+    template<typename X>
+    static auto check(X& x) -> decltype(x.insertBatch(std::declval<iterator>(), std::declval<iterator>()));
+    static substitution_failure check(...);
+public:
+    using type = decltype(check(std::declval<T&>()));
+};
+
+template<typename T>
+struct has_insert_batch : substitution_succeeded<typename get_insert_batch_result<T>::type>
+{};
+
+template<typename T>
+constexpr bool Has_insert_batch()
+{
+    return has_insert_batch<T>::value;
+}
+
+template<typename Container, bool C = Has_insert_batch<Container>()>
+struct BatchStruct
+{
+    template<typename Iterator>
+    static void insert(Container& container, Iterator first, Iterator last)
+    {
+        container.insertBatch(first, last);
+    }
+
+    template<typename Iterator>
+    static void erase(Container& container, Iterator first, Iterator last)
+    {
+        container.eraseBatch(first, last);
+    }
+};
+
+template<typename Container>
+struct BatchStruct<Container, false>
+{
+    template<typename Iterator>
+    static void insert(Container& container, Iterator first, Iterator last)
+    {
+        for (auto iter{ first }; iter != last; ++iter)
+        {
+            container.insert(*iter);
+        }
+    }
+
+    template<typename Iterator>
+    static void erase(Container& container, Iterator first, Iterator last)
+    {
+        for (auto iter{ first }; iter != last; ++iter)
+        {
+            container.erase(*iter);
+        }
+    }
+};
+
 template<typename Container>
 ContainerDescription getDescription()
 {
@@ -83,6 +194,22 @@ ContainerDescription getDescription()
     {
         return ContainerDescription{ "std::map", "MAP", true };
     }
+    else if (std::is_same<Container, rbt_pool_tree>::value)
+    {
+        return ContainerDescription{ "Red Black Tree (node pool)", "RBTp", true };
+    }
+    else if (std::is_same<Container, avl_pool_tree>::value)
+    {
+        return ContainerDescription{ "AVL Tree (node pool)", "AVLp", true };
+    }
+    else if (std::is_same<Container, aa_pool_tree>::value)
+    {
+        return ContainerDescription{ "AA Tree (node pool)", "AAp", true };
+    }
+    else if (std::is_same<Container, bst_pool_tree>::value)
+    {
+        return ContainerDescription{ "Binary Search Tree (node pool)", "BSTp", false };
+    }
     else if (std::is_same<Container, tree1>::value)
     {
         return ContainerDescription{ "tree1", "---", false };
@@ -124,6 +251,89 @@ int insertValues(Container& container, const std::vector<Key>& keys,
     return static_cast<int>(duration);
 }
 
+template<typename Container, typename Key, typename Value>
+int bulkLoadValues(Container& container, const std::vector<Key>& keys,
+                   const std::vector<Value>& values)
+{
+    if (keys.size() != values.size())
+    {
+        return -1;
+    }
+
+    using pair_type = std::pair<typename Container::key_type, typename Container::mapped_type>;
+    std::vector<pair_type> pairs;
+    pairs.reserve(keys.size());
+    for (size_t i{ 0 }; i < keys.size(); ++i)
+    {
+        pairs.push_back(pair_type{ keys[i], values[i] });
+    }
+
+    auto keyLess = [](const pair_type& a, const pair_type& b) { return a.first < b.first; };
+    auto keyEqual = [](const pair_type& a, const pair_type& b) { return a.first == b.first; };
+
+    // The sorting is included in the measured time
+    Timer timer;
+    if (not std::is_sorted(pairs.begin(), pairs.end(), keyLess))
+    {
+        std::stable_sort(pairs.begin(), pairs.end(), keyLess);
+    }
+    auto last{ std::unique(pairs.begin(), pairs.end(), keyEqual) };
+    BulkLoadStruct<Container>::load(container, pairs.begin(), last);
+    double duration{ timer.elapsed() };
+
+    if (VERBOSE)
+    {
+        std::cout << "Bulk loaded " << keys.size() << " to ";
+        std::cout << getDescription<Container>().name_ << std::endl;
+        std::cout << "Time duration: " << duration << " ms" << std::endl;
+        std::cout << getDescription<Container>().name_;
+        std::cout << " contains " << container.size() << " nodes. ";
+        std::cout << "Tree height is " << getHeight(container) << std::endl;
+        std::cout << std::endl;
+    }
+
+    return static_cast<int>(duration);
+}
+
+template<typename Container, typename Key, typename Value>
+int insertBatchValues(Container& container, const std::vector<Key>& keys,
+                      const std::vector<Value>& values, int batchSize)
+{
+    if (keys.size() != values.size() or batchSize <= 0)
+    {
+        return -1;
+    }
+
+    using pair_type = std::pair<typename Container::key_type, typename Container::mapped_type>;
+    std::vector<pair_type> pairs;
+    pairs.reserve(keys.size());
+    for (size_t i{ 0 }; i < keys.size(); ++i)
+    {
+        pairs.push_back(pair_type{ keys[i], values[i] });
+    }
+
+    Timer timer;
+    for (size_t i{ 0 }; i < pairs.size(); i += batchSize)
+    {
+        size_t end{ std::min(i + batchSize, pairs.size()) };
+        BatchStruct<Container>::insert(container, pairs.begin() + i, pairs.begin() + end);
+    }
+    double duration{ timer.elapsed() };
+
+    if (VERBOSE)
+    {
+        std::cout << "Inserted " << keys.size() << " in batches of " << batchSize << " to ";
+        std::cout << getDescription<Container>().name_ << std::endl;
+        std::cout << "Time duration: " << duration << " ms" << std::endl;
+        std::cout << getDescription<Container>().name_;
+        std::cout << " contains " << container.size() << " nodes. ";
+        std::cout << "Tree height is " << getHeight(container) << std::endl;
+        std::cout << std::endl;
+    }
+
+    return static_cast<int>(duration);
+}
+
 template<typename Container, typename Key>
 int searchValues(Container& container, const std::vector<Key>& keys)
 {
@@ -169,6 +379,36 @@ int deleteValues(Container& container, const std::vector<Key>& keys)
     return static_cast<int>(duration);
 }
 
+template<typename Container, typename Key>
+int deleteBatchValues(Container& container, const std::vector<Key>& keys, int batchSize)
+{
+    if (batchSize <= 0)
+    {
+        return -1;
+    }
+
+    Timer timer;
+    for (size_t i{ 0 }; i < keys.size(); i += batchSize)
+    {
+        size_t end{ std::min(i + batchSize, keys.size()) };
+        BatchStruct<Container>::erase(container, keys.begin() + i, keys.begin() + end);
+    }
+    double duration{ timer.elapsed() };
+
+    if (VERBOSE)
+    {
+        std::cout << "Deleted " << keys.size() << " in batches of " << batchSize << " from ";
+        std::cout << getDescription<Container>().name_ << std::endl;
+        std::cout << "Time duration: " << duration << " ms" << std::endl;
+        std::cout << getDescription<Container>().name_;
+        std::cout << " contains " << container.size() << " nodes. ";
+        std::cout << "Tree height is " << getHeight(container) << std::endl;
+        std::cout << std::endl;
+    }
+
+    return static_cast<int>(duration);
+}
+
 template<typename Container>
 TestTime runTest(Container& container, const TestData& testData)
 {
@@ -183,19 +423,52 @@ TestTime runTest(Container& container, const TestData& testData)
         std::cout << std::setw(9) << " " << getDescription<Container>().name_ << std::endl;
         container.clear();
         newTest.tree_ = getDescription<Container>().identifier_;
-        newTest.insert1_ = insertValues(container, testData.insertKeys1, testData.insertData1);
+        int batchSize{ testData.options.batchSize_ };
+        if (testData.options.bulkLoad_)
+        {
+            newTest.insert1_ = bulkLoadValues(container, testData.insertKeys1, testData.insertData1);
+        }
+        else if (batchSize > 0)
+        {
+            newTest.insert1_ = insertBatchValues(container, testData.insertKeys1, testData.insertData1, batchSize);
+        }
+        else
+        {
+            newTest.insert1_ = insertValues(container, testData.insertKeys1, testData.insertData1);
+        }
         newTest.height1_ = getHeight(container);
         newTest.search1a_ = searchValues(container, testData.searchKeys1);
         newTest.search1b_ = searchValues(container, testData.searchKeysAll);
-        newTest.delete1_ = deleteValues(container, testData.deleteKeys1);
+        if (batchSize > 0)
+        {
+            newTest.delete1_ = deleteBatchValues(container, testData.deleteKeys1, batchSize);
+        }
+        else
+        {
+            newTest.delete1_ = deleteValues(container, testData.deleteKeys1);
+        }
         newTest.height2_ = getHeight(container);
         newTest.search2a_ = searchValues(container, testData.searchKeys2);
         newTest.search2b_ = searchValues(container, testData.searchKeysAll);
-        newTest.insert2_ = insertValues(container, testData.insertKeys2, testData.insertData2);
+        if (batchSize > 0)
+        {
+            newTest.insert2_ = insertBatchValues(container, testData.insertKeys2, testData.insertData2, batchSize);
+        }
+        else
+        {
+            newTest.insert2_ = insertValues(container, testData.insertKeys2, testData.insertData2);
+        }
         newTest.height3_ = getHeight(container);
         newTest.search3a_ = searchValues(container, testData.searchKeys3);
         newTest.search3b_ = searchValues(container, testData.searchKeysAll);
-        newTest.delete2_ = deleteValues(container, testData.deleteKeys2);
+        if (batchSize > 0)
+        {
+            newTest.delete2_ = deleteBatchValues(container, testData.deleteKeys2, batchSize);
+        }
+        else
+        {
+            newTest.delete2_ = deleteValues(container, testData.deleteKeys2);
+        }
         newTest.total_ = newTest.insert1_ + newTest.insert2_ +
                          newTest.delete1_ + newTest.delete2_ +
                          newTest.search1a_ + newTest.search2a_ + newTest.search3a_ +
@@ -10,6 +10,7 @@
 #include "binarysearchtree.hh"
 #include "redblacktree.hh"
 #include "bsttrees.hh"
+#include "nodeallocator.hh"
 #include <map>
 #include <string>
 #include <vector>
@@ -25,6 +26,12 @@ using aa_tree = AATree<AANode<key_type, data_type>>;
 using map_tree = std::map<key_type, data_type>;
 using tree1 = SimpleBST<key_type, data_type>;
 
+// The same containers with the nodes allocated from a NodePool
+using bst_pool_tree = BinarySearchTree<TreeNode<key_type, data_type>, NodePool>;
+using rbt_pool_tree = RedBlackTree<RedBlackNode<key_type, data_type>, NodePool>;
+using avl_pool_tree = AVLTree<AVLNode<key_type, data_type>, NodePool>;
+using aa_pool_tree = AATree<AANode<key_type, data_type>, NodePool>;
+
 // A struct for storing the test results
 struct TestTime
 {
@@ -47,10 +54,21 @@ struct TestTime
     int total_;
 };
 
+// Optional test settings given from the command line
+//  bulkLoad_: whether the first insertion phase builds the trees with bulkLoad
+//  batchSize_: the size of the batches given to insertBatch and eraseBatch,
+//              0 if the values are inserted and deleted one at a time
+struct TestOptions
+{
+    bool bulkLoad_;
+    int batchSize_;
+};
+
 struct TestData
 {
     std::string testName;
     bool bst;
+    TestOptions options;
     std::vector<key_type> insertKeys1;
     std::vector<key_type> insertKeys2;
     std::vector<key_type> searchKeys1;
@@ -88,12 +106,29 @@ template<typename Container, typename Key, typename Value>
 int insertValues(Container& container, const std::vector<Key>& keys,
                  const std::vector<Value>& values);
 
+// Sorts the values and loads them to the container with bulkLoad or, if the
+// container has no bulkLoad, by inserting them in sorted order
+template<typename Container, typename Key, typename Value>
+int bulkLoadValues(Container& container, const std::vector<Key>& keys,
+                   const std::vector<Value>& values);
+
+// Inserts the values in consecutive batches of batchSize values with
+// insertBatch or, if the container has no insertBatch, one by one
+template<typename Container, typename Key, typename Value>
+int insertBatchValues(Container& container, const std::vector<Key>& keys,
+                      const std::vector<Value>& values, int batchSize);
+
 template<typename Container, typename Key>
 int searchValues(Container& container, const std::vector<Key>& keys);
 
 template<typename Container, typename Key>
 int deleteValues(Container& container, const std::vector<Key>& keys);
 
+// Deletes the keys in consecutive batches of batchSize keys with eraseBatch
+// or, if the container has no eraseBatch, one by one
+template<typename Container, typename Key>
+int deleteBatchValues(Container& container, const std::vector<Key>& keys, int batchSize);
+
 template<typename Container>
 TestTime runTest(Container& container, const TestData& testData);
 